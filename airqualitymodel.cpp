@@ -0,0 +1,246 @@
+/**
+ * @file airqualitymodel.cpp
+ * @brief Definicje metod klas StringPool, SeriesArena i AirQualityModel.
+ *
+ * Ten plik zawiera implementację zwartego modelu danych:
+ * - internowanie napisów,
+ * - przydział ciągłych tablic serii pomiarowych z areny,
+ * - ładowanie odpowiedzi API GIOŚ do struktur z 32-bitowymi identyfikatorami.
+ */
+
+#include "airqualitymodel.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QVarLengthArray>
+#include <limits>
+#include <utility>
+
+/**
+ * @brief Odczytuje współrzędną zapisaną jako liczba lub napis.
+ *
+ * API GIOŚ zwraca współrzędne stacji jako napisy (np. "50.972167").
+ *
+ * @param value Wartość JSON.
+ * @return Współrzędna.
+ */
+static float coordinate(const QJsonValue &value) {
+    return value.isString() ? value.toString().toFloat() : float(value.toDouble());
+}
+
+/**
+ * @brief Konstruktor klasy StringPool
+ *
+ * Rezerwuje identyfikator 0 dla pustego napisu.
+ */
+StringPool::StringPool() {
+    strings.append(QString());
+    index.insert(QString(), 0);
+}
+
+/**
+ * @brief Dodaje napis do puli
+ *
+ * @param text Napis do dodania
+ * @return Identyfikator napisu – istniejący, jeśli napis był już w puli
+ */
+quint32 StringPool::intern(const QString &text) {
+    auto it = index.constFind(text);
+    if (it != index.constEnd())
+        return it.value();
+
+    quint32 id = quint32(strings.size());
+    strings.append(text);
+    index.insert(text, id);
+    return id;
+}
+
+/**
+ * @brief Przydziela fragment na podaną liczbę pomiarów
+ *
+ * Fragment pochodzi z ostatniego bloku, jeśli jest w nim miejsce; w przeciwnym razie
+ * tworzony jest nowy blok (większy od domyślnego tylko dla bardzo długich serii).
+ *
+ * @param count Liczba pomiarów
+ * @return Przydzielony fragment
+ */
+SeriesArena::Span SeriesArena::allocate(quint32 count) {
+    if (count == 0)
+        return Span();
+
+    if (blocks.empty() || blocks.back().capacity - blocks.back().used < count) {
+        Block block;
+        block.capacity = qMax(count, BLOCK_SIZE);
+        block.timestamps.reset(new quint32[block.capacity]);
+        block.values.reset(new double[block.capacity]);
+        blocks.push_back(std::move(block));
+    }
+
+    Block &block = blocks.back();
+    Span span;
+    span.timestamps = block.timestamps.get() + block.used;
+    span.values = block.values.get() + block.used;
+    span.capacity = count;
+    block.used += count;
+    return span;
+}
+
+/**
+ * @brief Zwraca liczbę bajtów zajmowanych przez bloki areny
+ *
+ * @return Rozmiar bloków w bajtach
+ */
+qsizetype SeriesArena::capacityBytes() const {
+    qsizetype bytes = 0;
+    for (const Block &block : blocks)
+        bytes += qsizetype(block.capacity) * (sizeof(quint32) + sizeof(double));
+    return bytes;
+}
+
+/**
+ * @brief Ładuje listę stacji
+ *
+ * Nazwa stacji, miasto i województwo trafiają do puli napisów.
+ *
+ * @param data Odpowiedź `station/findAll` w formacie JSON
+ */
+void AirQualityModel::loadStations(const QByteArray &data) {
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isArray()) return;
+
+    const QJsonArray array = doc.array();
+    for (const QJsonValue &val : array) {
+        QJsonObject obj = val.toObject();
+        QJsonObject city = obj["city"].toObject();
+
+        StationRecord record;
+        record.id = quint32(obj["id"].toInt());
+        record.name = strings.intern(obj["stationName"].toString());
+        record.city = strings.intern(city["name"].toString());
+        record.province = strings.intern(city["commune"].toObject()["provinceName"].toString());
+        record.latitude = coordinate(obj["gegrLat"]);
+        record.longitude = coordinate(obj["gegrLon"]);
+
+        auto it = stationIndex.constFind(record.id);
+        if (it != stationIndex.constEnd()) {
+            stationList[it.value()] = record;
+        } else {
+            stationIndex.insert(record.id, quint32(stationList.size()));
+            stationList.append(record);
+        }
+    }
+}
+
+/**
+ * @brief Ładuje listę czujników stacji
+ *
+ * @param data Odpowiedź `station/sensors/{id}` w formacie JSON
+ */
+void AirQualityModel::loadSensors(const QByteArray &data) {
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isArray()) return;
+
+    const QJsonArray array = doc.array();
+    for (const QJsonValue &val : array) {
+        QJsonObject obj = val.toObject();
+        QJsonObject param = obj["param"].toObject();
+
+        SensorRecord &record = sensorRef(quint32(obj["id"].toInt()));
+        record.stationId = quint32(obj["stationId"].toInt());
+        record.paramName = strings.intern(param["paramName"].toString());
+        record.paramCode = strings.intern(param["paramCode"].toString());
+    }
+}
+
+/**
+ * @brief Ładuje serię pomiarową czujnika
+ *
+ * Pomiary zapisywane są w kolejności z odpowiedzi API. Pomijane są pomiary bez wartości
+ * oraz takie, których daty nie da się odczytać lub nie mieszczą się w zakresie 32-bitowego
+ * czasu uniksowego. Jeśli czujnik nie był jeszcze znany, dodawany jest z kodem parametru
+ * z pola `key`.
+ *
+ * @param sensorId Identyfikator czujnika
+ * @param data Odpowiedź `data/getData/{id}` w formacie JSON
+ */
+void AirQualityModel::loadMeasurements(quint32 sensorId, const QByteArray &data) {
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) return;
+
+    QJsonObject rootObj = doc.object();
+    const QJsonArray values = rootObj["values"].toArray();
+
+    SensorRecord &record = sensorRef(sensorId);
+    if (record.paramCode == 0)
+        record.paramCode = strings.intern(rootObj["key"].toString());
+
+    QVarLengthArray<std::pair<quint32, double>, 256> kept;
+    kept.reserve(values.size());
+    for (const QJsonValue &val : values) {
+        QJsonObject obj = val.toObject();
+        if (!obj["value"].isDouble())
+            continue;
+
+        QDateTime timestamp = QDateTime::fromString(obj["date"].toString(), Qt::ISODate);
+        if (!timestamp.isValid())
+            continue;
+        qint64 secs = timestamp.toSecsSinceEpoch();
+        if (secs < 0 || secs > std::numeric_limits<quint32>::max())
+            continue;
+
+        kept.append({quint32(secs), obj["value"].toDouble()});
+    }
+
+    quint32 count = quint32(kept.size());
+
+    // Odświeżona seria zwykle ma tę samą długość, więc fragment areny jest używany ponownie
+    if (count > record.series.capacity)
+        record.series = arena.allocate(count);
+
+    for (quint32 i = 0; i < count; ++i) {
+        record.series.timestamps[i] = kept[i].first;
+        record.series.values[i] = kept[i].second;
+    }
+    record.seriesCount = count;
+}
+
+/**
+ * @brief Wyszukuje stację po identyfikatorze
+ *
+ * @param id Identyfikator stacji
+ * @return Wskaźnik do stacji lub nullptr
+ */
+const StationRecord *AirQualityModel::station(quint32 id) const {
+    auto it = stationIndex.constFind(id);
+    return it != stationIndex.constEnd() ? &stationList.at(it.value()) : nullptr;
+}
+
+/**
+ * @brief Wyszukuje czujnik po identyfikatorze
+ *
+ * @param id Identyfikator czujnika
+ * @return Wskaźnik do czujnika lub nullptr
+ */
+const SensorRecord *AirQualityModel::sensor(quint32 id) const {
+    auto it = sensorIndex.constFind(id);
+    return it != sensorIndex.constEnd() ? &sensorList.at(it.value()) : nullptr;
+}
+
+/**
+ * @brief Zwraca czujnik o podanym identyfikatorze, dodając go w razie potrzeby
+ *
+ * @param id Identyfikator czujnika
+ * @return Referencja do czujnika
+ */
+SensorRecord &AirQualityModel::sensorRef(quint32 id) {
+    auto it = sensorIndex.constFind(id);
+    if (it != sensorIndex.constEnd())
+        return sensorList[it.value()];
+
+    SensorRecord record;
+    record.id = id;
+    sensorIndex.insert(id, quint32(sensorList.size()));
+    sensorList.append(record);
+    return sensorList.last();
+}
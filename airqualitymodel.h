@@ -0,0 +1,259 @@
+/**
+ * @file airqualitymodel.h
+ * @brief Nagłówek zwartego modelu danych stacji, czujników i serii pomiarowych.
+ *
+ * Plik ten zawiera deklaracje klas StringPool, SeriesArena i AirQualityModel.
+ * Model przechowuje dane z API GIOŚ w postaci prostych struktur z 32-bitowymi
+ * identyfikatorami zamiast obiektów QJsonObject:
+ * - powtarzające się napisy (nazwy parametrów, miasta, województwa) trzymane są raz w puli,
+ * - stacje i czujniki to struktury z indeksami napisów z puli,
+ * - serie pomiarowe to ciągłe tablice czasów i wartości przydzielane z areny
+ *   (wartości jako double, aby serwer pośredniczący zwracał je bez utraty precyzji).
+ */
+
+#ifndef AIRQUALITYMODEL_H
+#define AIRQUALITYMODEL_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <memory>
+#include <vector>
+
+/**
+ * @class StringPool
+ * @brief Pula napisów przechowująca każdy napis tylko raz.
+ *
+ * Każdy napis otrzymuje 32-bitowy identyfikator; ponowne dodanie tego samego
+ * napisu zwraca ten sam identyfikator. Identyfikator 0 oznacza pusty napis.
+ */
+class StringPool
+{
+public:
+    /**
+     * @brief Konstruktor klasy StringPool.
+     *
+     * Rezerwuje identyfikator 0 dla pustego napisu.
+     */
+    StringPool();
+
+    /**
+     * @brief Dodaje napis do puli.
+     *
+     * @param text Napis do dodania.
+     * @return Identyfikator napisu w puli.
+     */
+    quint32 intern(const QString &text);
+
+    /**
+     * @brief Zwraca napis o podanym identyfikatorze.
+     *
+     * @param id Identyfikator napisu.
+     * @return Napis z puli.
+     */
+    const QString &at(quint32 id) const { return strings.at(id); }
+
+    /**
+     * @brief Zwraca liczbę napisów w puli.
+     *
+     * @return Liczba różnych napisów.
+     */
+    qsizetype size() const { return strings.size(); }
+
+private:
+    QList<QString> strings; /**< Napisy według identyfikatora */
+    QHash<QString, quint32> index; /**< Odwzorowanie napisu na identyfikator */
+};
+
+/**
+ * @class SeriesArena
+ * @brief Arena przydzielająca ciągłe tablice czasów i wartości serii pomiarowych.
+ *
+ * Pamięć przydzielana jest dużymi blokami, z których kolejne serie dostają ciągłe
+ * fragmenty. Pojedyncze fragmenty nie są zwalniane – cała pamięć zwalniana jest
+ * razem z areną.
+ */
+class SeriesArena
+{
+public:
+    /**
+     * @struct Span
+     * @brief Fragment areny przydzielony jednej serii.
+     */
+    struct Span {
+        quint32 *timestamps = nullptr; /**< Czasy pomiarów w sekundach od epoki (UTC) */
+        double *values = nullptr;      /**< Wartości pomiarów */
+        quint32 capacity = 0;          /**< Liczba miejsc we fragmencie */
+    };
+
+    /**
+     * @brief Przydziela fragment na podaną liczbę pomiarów.
+     *
+     * @param count Liczba pomiarów.
+     * @return Przydzielony fragment.
+     */
+    Span allocate(quint32 count);
+
+    /**
+     * @brief Zwraca liczbę bajtów zajmowanych przez bloki areny.
+     *
+     * @return Rozmiar bloków w bajtach.
+     */
+    qsizetype capacityBytes() const;
+
+private:
+    /// Domyślna liczba pomiarów w jednym bloku.
+    static constexpr quint32 BLOCK_SIZE = 1 << 16;
+
+    /**
+     * @struct Block
+     * @brief Blok pamięci areny.
+     */
+    struct Block {
+        std::unique_ptr<quint32[]> timestamps; /**< Tablica czasów */
+        std::unique_ptr<double[]> values;      /**< Tablica wartości */
+        quint32 capacity = 0;                  /**< Rozmiar bloku */
+        quint32 used = 0;                      /**< Liczba zajętych miejsc */
+    };
+
+    std::vector<Block> blocks; /**< Przydzielone bloki */
+};
+
+/**
+ * @struct StationRecord
+ * @brief Stacja pomiarowa w zwartym modelu.
+ */
+struct StationRecord {
+    quint32 id = 0;        /**< Identyfikator stacji w API GIOŚ */
+    quint32 name = 0;      /**< Nazwa stacji (identyfikator w puli napisów) */
+    quint32 city = 0;      /**< Miasto (identyfikator w puli napisów) */
+    quint32 province = 0;  /**< Województwo (identyfikator w puli napisów) */
+    float latitude = 0;    /**< Szerokość geograficzna */
+    float longitude = 0;   /**< Długość geograficzna */
+};
+
+/**
+ * @struct SensorRecord
+ * @brief Czujnik wraz z serią pomiarową w zwartym modelu.
+ */
+struct SensorRecord {
+    quint32 id = 0;                  /**< Identyfikator czujnika w API GIOŚ */
+    quint32 stationId = 0;           /**< Identyfikator stacji (0, jeśli nieznana) */
+    quint32 paramName = 0;           /**< Nazwa parametru (identyfikator w puli napisów) */
+    quint32 paramCode = 0;           /**< Kod parametru (identyfikator w puli napisów) */
+    quint32 seriesCount = 0;         /**< Liczba pomiarów w serii */
+    SeriesArena::Span series;        /**< Czasy i wartości pomiarów */
+};
+
+/**
+ * @class AirQualityModel
+ * @brief Zwarty model stacji, czujników i serii pomiarowych.
+ *
+ * Dane ładowane są z odpowiedzi API GIOŚ (`station/findAll`, `station/sensors/{id}`,
+ * `data/getData/{id}`). Obiekty JSON są używane tylko podczas ładowania;
+ * model przechowuje wyłącznie struktury, pulę napisów i arenę serii.
+ */
+class AirQualityModel
+{
+public:
+    /**
+     * @brief Ładuje listę stacji.
+     *
+     * Istniejące stacje o tym samym identyfikatorze są aktualizowane.
+     *
+     * @param data Odpowiedź `station/findAll` w formacie JSON.
+     */
+    void loadStations(const QByteArray &data);
+
+    /**
+     * @brief Ładuje listę czujników stacji.
+     *
+     * Serie pomiarowe istniejących czujników są zachowywane.
+     *
+     * @param data Odpowiedź `station/sensors/{id}` w formacie JSON.
+     */
+    void loadSensors(const QByteArray &data);
+
+    /**
+     * @brief Ładuje serię pomiarową czujnika.
+     *
+     * Pomiary bez wartości oraz z datą niepoprawną lub spoza zakresu 32-bitowego
+     * czasu uniksowego są pomijane. Jeśli nowa seria mieści się w dotychczasowym
+     * fragmencie areny, jest on używany ponownie.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param data Odpowiedź `data/getData/{id}` w formacie JSON.
+     */
+    void loadMeasurements(quint32 sensorId, const QByteArray &data);
+
+    /**
+     * @brief Wyszukuje stację po identyfikatorze.
+     *
+     * @param id Identyfikator stacji.
+     * @return Wskaźnik do stacji lub nullptr, jeśli jej nie ma.
+     */
+    const StationRecord *station(quint32 id) const;
+
+    /**
+     * @brief Wyszukuje czujnik po identyfikatorze.
+     *
+     * @param id Identyfikator czujnika.
+     * @return Wskaźnik do czujnika lub nullptr, jeśli go nie ma.
+     */
+    const SensorRecord *sensor(quint32 id) const;
+
+    /**
+     * @brief Zwraca wszystkie stacje.
+     *
+     * @return Lista stacji.
+     */
+    const QList<StationRecord> &stations() const { return stationList; }
+
+    /**
+     * @brief Zwraca wszystkie czujniki.
+     *
+     * @return Lista czujników.
+     */
+    const QList<SensorRecord> &sensors() const { return sensorList; }
+
+    /**
+     * @brief Zwraca napis z puli modelu.
+     *
+     * @param id Identyfikator napisu.
+     * @return Napis.
+     */
+    const QString &text(quint32 id) const { return strings.at(id); }
+
+    /**
+     * @brief Zwraca pulę napisów modelu.
+     *
+     * @return Pula napisów.
+     */
+    const StringPool &stringPool() const { return strings; }
+
+    /**
+     * @brief Zwraca arenę serii pomiarowych modelu.
+     *
+     * @return Arena serii.
+     */
+    const SeriesArena &seriesArena() const { return arena; }
+
+private:
+    StringPool strings; /**< Pula napisów */
+    SeriesArena arena; /**< Arena serii pomiarowych */
+    QList<StationRecord> stationList; /**< Stacje */
+    QList<SensorRecord> sensorList; /**< Czujniki */
+    QHash<quint32, quint32> stationIndex; /**< Identyfikator stacji → indeks w stationList */
+    QHash<quint32, quint32> sensorIndex; /**< Identyfikator czujnika → indeks w sensorList */
+
+    /**
+     * @brief Zwraca czujnik o podanym identyfikatorze, dodając go w razie potrzeby.
+     *
+     * @param id Identyfikator czujnika.
+     * @return Referencja do czujnika.
+     */
+    SensorRecord &sensorRef(quint32 id);
+};
+
+#endif // AIRQUALITYMODEL_H
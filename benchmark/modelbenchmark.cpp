@@ -0,0 +1,425 @@
+/**
+ * @file modelbenchmark.cpp
+ * @brief Porównanie zwartego modelu AirQualityModel z przechowywaniem obiektów JSON.
+ *
+ * Program generuje syntetyczne dane w skali kraju (stacje, czujniki i serie pomiarowe
+ * w formacie odpowiedzi API GIOŚ), a następnie mierzy:
+ * - czas ładowania danych,
+ * - przyrost zajętej pamięci sterty,
+ * - czas wyszukiwania czujnika i jego stacji po identyfikatorze,
+ * - czas przejścia po wszystkich seriach pomiarowych.
+ *
+ * Obiekty JSON mierzone są w dwóch wariantach: z pełnymi odpowiedziami API oraz tylko
+ * z polami, które przechowuje model (bez adresu, gminy, powiatu, identyfikatorów miasta
+ * i parametru, wzoru parametru i pomiarów bez wartości; data pomiaru jako liczba sekund).
+ * Dla modelu raportowana jest też liczba napisów w puli i rozmiar bloków areny.
+ *
+ * Pamięć mierzona jest przez mallinfo2() (glibc; bloki z brk i z mmap) lub PrivateUsage
+ * procesu (Windows); na pozostałych systemach pomiar pamięci jest pomijany.
+ *
+ * Użycie: `AirQualityModelBenchmark [godziny]` (domyślnie 72 pomiary na czujnik).
+ */
+
+#include "../airqualitymodel.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/// Liczba stacji (rząd wielkości sieci GIOŚ).
+static const int STATION_COUNT = 280;
+/// Liczba czujników na stację.
+static const int SENSORS_PER_STATION = 5;
+/// Liczba losowych wyszukiwań czujników.
+static const int LOOKUP_COUNT = 1000000;
+/// Liczba przejść po wszystkich seriach.
+static const int SCAN_ROUNDS = 100;
+
+/**
+ * @brief Zwraca liczbę bajtów sterty zajętych przez proces.
+ *
+ * @return Liczba bajtów lub -1, jeśli pomiar nie jest dostępny.
+ */
+static qint64 heapInUse() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS_EX counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+        return qint64(counters.PrivateUsage);
+    return -1;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // Duże przydziały (np. bloki areny) glibc obsługuje przez mmap – są liczone w hblkhd, nie w uordblks
+    struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @struct Dataset
+ * @brief Syntetyczne odpowiedzi API GIOŚ.
+ */
+struct Dataset {
+    QByteArray stations;                 /**< Odpowiedź `station/findAll` */
+    QList<QByteArray> sensors;           /**< Odpowiedzi `station/sensors/{id}` */
+    QList<QPair<int, QByteArray>> data;  /**< Odpowiedzi `data/getData/{id}` */
+    QList<int> sensorIds;                /**< Identyfikatory wszystkich czujników */
+};
+
+/**
+ * @brief Generuje syntetyczne dane w formacie API GIOŚ.
+ *
+ * Nazwy parametrów, miasta i województwa powtarzają się tak jak w danych rzeczywistych.
+ *
+ * @param hours Liczba pomiarów godzinowych na czujnik.
+ * @return Wygenerowane odpowiedzi.
+ */
+static Dataset generateDataset(int hours) {
+    static const char *const params[][2] = {
+        {"pył zawieszony PM10", "PM10"}, {"pył zawieszony PM2.5", "PM2.5"},
+        {"dwutlenek azotu", "NO2"}, {"ozon", "O3"}, {"dwutlenek siarki", "SO2"},
+        {"benzen", "C6H6"}, {"tlenek węgla", "CO"}, {"tlenki azotu", "NOx"},
+    };
+    static const char *const provinces[] = {
+        "DOLNOŚLĄSKIE", "KUJAWSKO-POMORSKIE", "LUBELSKIE", "LUBUSKIE", "ŁÓDZKIE", "MAŁOPOLSKIE",
+        "MAZOWIECKIE", "OPOLSKIE", "PODKARPACKIE", "PODLASKIE", "POMORSKIE", "ŚLĄSKIE",
+        "ŚWIĘTOKRZYSKIE", "WARMIŃSKO-MAZURSKIE", "WIELKOPOLSKIE", "ZACHODNIOPOMORSKIE",
+    };
+
+    QRandomGenerator random(2025);
+    Dataset dataset;
+    QJsonArray stations;
+    QDateTime start = QDateTime::currentDateTime().addSecs(-3600LL * hours);
+    start.setTime(QTime(start.time().hour(), 0));
+
+    for (int s = 0; s < STATION_COUNT; ++s) {
+        int stationId = 100 + s;
+        QString city = QString("Miasto %1").arg(s / 2);
+
+        QJsonObject commune;
+        commune["communeName"] = city;
+        commune["districtName"] = QString("powiat %1").arg(s / 4);
+        commune["provinceName"] = provinces[s % 16];
+        QJsonObject cityObj;
+        cityObj["id"] = 1000 + s / 2;
+        cityObj["name"] = city;
+        cityObj["commune"] = commune;
+        QJsonObject station;
+        station["id"] = stationId;
+        station["stationName"] = QString("%1, ul. Pomiarowa %2").arg(city).arg(s);
+        station["gegrLat"] = QString::number(49.0 + random.bounded(5.0), 'f', 6);
+        station["gegrLon"] = QString::number(14.1 + random.bounded(10.0), 'f', 6);
+        station["city"] = cityObj;
+        station["addressStreet"] = QString("ul. Pomiarowa %1").arg(s);
+        stations.append(station);
+
+        QJsonArray sensors;
+        for (int p = 0; p < SENSORS_PER_STATION; ++p) {
+            int sensorId = stationId * 10 + p;
+            int paramIndex = (s + p) % 8;
+            QJsonObject param;
+            param["paramName"] = params[paramIndex][0];
+            param["paramFormula"] = params[paramIndex][1];
+            param["paramCode"] = params[paramIndex][1];
+            param["idParam"] = paramIndex + 1;
+            QJsonObject sensor;
+            sensor["id"] = sensorId;
+            sensor["stationId"] = stationId;
+            sensor["param"] = param;
+            sensors.append(sensor);
+            dataset.sensorIds.append(sensorId);
+
+            // Najnowsze pomiary na początku, jak w API; część pomiarów bez wartości
+            QJsonArray values;
+            for (int h = hours - 1; h >= 0; --h) {
+                QJsonObject value;
+                value["date"] = start.addSecs(3600LL * h).toString("yyyy-MM-dd HH:mm:ss");
+                if (random.bounded(20) == 0)
+                    value["value"] = QJsonValue::Null;
+                else
+                    value["value"] = random.bounded(120.0);
+                values.append(value);
+            }
+            QJsonObject root;
+            root["key"] = params[paramIndex][1];
+            root["values"] = values;
+            dataset.data.append({sensorId, QJsonDocument(root).toJson(QJsonDocument::Compact)});
+        }
+        dataset.sensors.append(QJsonDocument(sensors).toJson(QJsonDocument::Compact));
+    }
+    dataset.stations = QJsonDocument(stations).toJson(QJsonDocument::Compact);
+    return dataset;
+}
+
+/**
+ * @brief Zostawia w stacji tylko pola przechowywane przez model.
+ *
+ * @param obj Stacja z odpowiedzi `station/findAll`.
+ * @return Stacja z identyfikatorem, nazwą, miastem, województwem i współrzędnymi.
+ */
+static QJsonObject trimStation(const QJsonObject &obj) {
+    QJsonObject city = obj["city"].toObject();
+    QJsonObject commune;
+    commune["provinceName"] = city["commune"].toObject()["provinceName"];
+    QJsonObject cityObj;
+    cityObj["name"] = city["name"];
+    cityObj["commune"] = commune;
+
+    QJsonObject station;
+    station["id"] = obj["id"];
+    station["stationName"] = obj["stationName"];
+    station["gegrLat"] = obj["gegrLat"];
+    station["gegrLon"] = obj["gegrLon"];
+    station["city"] = cityObj;
+    return station;
+}
+
+/**
+ * @brief Zostawia w czujniku tylko pola przechowywane przez model.
+ *
+ * @param obj Czujnik z odpowiedzi `station/sensors/{id}`.
+ * @return Czujnik z identyfikatorem, stacją, nazwą i kodem parametru.
+ */
+static QJsonObject trimSensor(const QJsonObject &obj) {
+    QJsonObject source = obj["param"].toObject();
+    QJsonObject param;
+    param["paramName"] = source["paramName"];
+    param["paramCode"] = source["paramCode"];
+
+    QJsonObject sensor;
+    sensor["id"] = obj["id"];
+    sensor["stationId"] = obj["stationId"];
+    sensor["param"] = param;
+    return sensor;
+}
+
+/**
+ * @brief Zostawia w serii pomiarowej tylko dane przechowywane przez model.
+ *
+ * Pomiary bez wartości są pomijane, a data zapisywana jest jako liczba sekund od epoki.
+ *
+ * @param obj Odpowiedź `data/getData/{id}`.
+ * @return Seria z kluczem parametru i pomiarami `{date, value}`.
+ */
+static QJsonObject trimMeasurements(const QJsonObject &obj) {
+    QJsonArray values;
+    for (const QJsonValue &val : obj["values"].toArray()) {
+        QJsonObject source = val.toObject();
+        if (!source["value"].isDouble())
+            continue;
+        QDateTime timestamp = QDateTime::fromString(source["date"].toString(), Qt::ISODate);
+        if (!timestamp.isValid())
+            continue;
+
+        QJsonObject value;
+        value["date"] = timestamp.toSecsSinceEpoch();
+        value["value"] = source["value"];
+        values.append(value);
+    }
+
+    QJsonObject root;
+    root["key"] = obj["key"];
+    root["values"] = values;
+    return root;
+}
+
+/**
+ * @struct JsonStore
+ * @brief Dotychczasowe podejście – przechowywanie sparsowanych obiektów JSON.
+ */
+struct JsonStore {
+    QHash<int, QJsonObject> stations;      /**< Stacje według identyfikatora */
+    QHash<int, QJsonObject> sensors;       /**< Czujniki według identyfikatora */
+    QHash<int, QJsonObject> measurements;  /**< Odpowiedzi `getData` według czujnika */
+};
+
+/**
+ * @struct Result
+ * @brief Wyniki pomiarów dla jednego podejścia.
+ */
+struct Result {
+    qint64 loadNs = 0;    /**< Czas ładowania */
+    qint64 memory = -1;   /**< Przyrost pamięci sterty */
+    qint64 lookupNs = 0;  /**< Czas wszystkich wyszukiwań */
+    qint64 scanNs = 0;    /**< Czas wszystkich przejść po seriach */
+    double checksum = 0;  /**< Suma kontrolna zapobiegająca pominięciu obliczeń */
+    qsizetype poolStrings = -1; /**< Liczba napisów w puli (tylko model) */
+    qint64 arenaBytes = -1;     /**< Rozmiar bloków areny serii (tylko model) */
+};
+
+/**
+ * @brief Mierzy podejście oparte na obiektach JSON.
+ *
+ * @param dataset Dane wejściowe.
+ * @param lookups Identyfikatory czujników do wyszukania.
+ * @param trimmed true, jeśli obiekty mają zawierać tylko pola przechowywane przez model.
+ * @return Wyniki pomiarów.
+ */
+static Result benchmarkJson(const Dataset &dataset, const QList<int> &lookups, bool trimmed) {
+    Result result;
+    qint64 before = heapInUse();
+    QElapsedTimer timer;
+    timer.start();
+
+    JsonStore store;
+    for (const QJsonValue &val : QJsonDocument::fromJson(dataset.stations).array()) {
+        QJsonObject obj = val.toObject();
+        store.stations.insert(obj["id"].toInt(), trimmed ? trimStation(obj) : obj);
+    }
+    for (const QByteArray &data : dataset.sensors) {
+        for (const QJsonValue &val : QJsonDocument::fromJson(data).array()) {
+            QJsonObject obj = val.toObject();
+            store.sensors.insert(obj["id"].toInt(), trimmed ? trimSensor(obj) : obj);
+        }
+    }
+    for (const auto &item : dataset.data) {
+        QJsonObject obj = QJsonDocument::fromJson(item.second).object();
+        store.measurements.insert(item.first, trimmed ? trimMeasurements(obj) : obj);
+    }
+
+    result.loadNs = timer.nsecsElapsed();
+    if (before >= 0)
+        result.memory = heapInUse() - before;
+
+    timer.restart();
+    for (int sensorId : lookups) {
+        QJsonObject sensor = store.sensors.value(sensorId);
+        QJsonObject station = store.stations.value(sensor["stationId"].toInt());
+        result.checksum += station["stationName"].toString().size()
+                           + sensor["param"].toObject()["paramName"].toString().size();
+    }
+    result.lookupNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int round = 0; round < SCAN_ROUNDS; ++round) {
+        for (auto it = store.measurements.constBegin(); it != store.measurements.constEnd(); ++it) {
+            double sum = 0;
+            int count = 0;
+            for (const QJsonValue &val : it.value()["values"].toArray()) {
+                QJsonValue value = val.toObject()["value"];
+                if (value.isDouble()) {
+                    sum += value.toDouble();
+                    ++count;
+                }
+            }
+            if (count > 0)
+                result.checksum += sum / count;
+        }
+    }
+    result.scanNs = timer.nsecsElapsed();
+    return result;
+}
+
+/**
+ * @brief Mierzy zwarty model AirQualityModel.
+ *
+ * @param dataset Dane wejściowe.
+ * @param lookups Identyfikatory czujników do wyszukania.
+ * @return Wyniki pomiarów.
+ */
+static Result benchmarkModel(const Dataset &dataset, const QList<int> &lookups) {
+    Result result;
+    qint64 before = heapInUse();
+    QElapsedTimer timer;
+    timer.start();
+
+    AirQualityModel model;
+    model.loadStations(dataset.stations);
+    for (const QByteArray &data : dataset.sensors)
+        model.loadSensors(data);
+    for (const auto &item : dataset.data)
+        model.loadMeasurements(quint32(item.first), item.second);
+
+    result.loadNs = timer.nsecsElapsed();
+    if (before >= 0)
+        result.memory = heapInUse() - before;
+    result.poolStrings = model.stringPool().size();
+    result.arenaBytes = model.seriesArena().capacityBytes();
+
+    timer.restart();
+    for (int sensorId : lookups) {
+        const SensorRecord *sensor = model.sensor(quint32(sensorId));
+        const StationRecord *station = model.station(sensor->stationId);
+        result.checksum += model.text(station->name).size() + model.text(sensor->paramName).size();
+    }
+    result.lookupNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int round = 0; round < SCAN_ROUNDS; ++round) {
+        for (const SensorRecord &sensor : model.sensors()) {
+            double sum = 0;
+            for (quint32 i = 0; i < sensor.seriesCount; ++i)
+                sum += sensor.series.values[i];
+            if (sensor.seriesCount > 0)
+                result.checksum += sum / sensor.seriesCount;
+        }
+    }
+    result.scanNs = timer.nsecsElapsed();
+    return result;
+}
+
+/**
+ * @brief Formatuje liczbę bajtów jako KiB.
+ *
+ * @param bytes Liczba bajtów (-1 oznacza brak pomiaru).
+ * @return Tekst do raportu.
+ */
+static QString formatMemory(qint64 bytes) {
+    return bytes < 0 ? QString("n/d") : QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+    int hours = args.size() > 1 ? qMax(1, args.at(1).toInt()) : 72;
+
+    QTextStream out(stdout);
+    Dataset dataset = generateDataset(hours);
+
+    QRandomGenerator random(42);
+    QList<int> lookups;
+    lookups.reserve(LOOKUP_COUNT);
+    for (int i = 0; i < LOOKUP_COUNT; ++i)
+        lookups.append(dataset.sensorIds.at(random.bounded(int(dataset.sensorIds.size()))));
+
+    Result json = benchmarkJson(dataset, lookups, false);
+    Result trimmed = benchmarkJson(dataset, lookups, true);
+    Result model = benchmarkModel(dataset, lookups);
+
+    out << "Stacje: " << STATION_COUNT << ", czujniki: " << dataset.sensorIds.size()
+        << ", pomiary na czujnik: " << hours << "\n\n";
+    out << QString("%1 %2 %3 %4").arg(QString(), -28)
+               .arg("JSON (pełny)", 20).arg("JSON (te same pola)", 20).arg("AirQualityModel", 20) << "\n";
+    out << QString("%1 %2 %3 %4").arg("Ładowanie [ms]", -28)
+               .arg(json.loadNs / 1e6, 20, 'f', 2).arg(trimmed.loadNs / 1e6, 20, 'f', 2)
+               .arg(model.loadNs / 1e6, 20, 'f', 2) << "\n";
+    out << QString("%1 %2 %3 %4").arg("Pamięć sterty", -28)
+               .arg(formatMemory(json.memory), 20).arg(formatMemory(trimmed.memory), 20)
+               .arg(formatMemory(model.memory), 20) << "\n";
+    out << QString("%1 %2 %3 %4").arg("Wyszukiwanie [ns/czujnik]", -28)
+               .arg(double(json.lookupNs) / LOOKUP_COUNT, 20, 'f', 1)
+               .arg(double(trimmed.lookupNs) / LOOKUP_COUNT, 20, 'f', 1)
+               .arg(double(model.lookupNs) / LOOKUP_COUNT, 20, 'f', 1) << "\n";
+    out << QString("%1 %2 %3 %4").arg("Przejście serii [ms]", -28)
+               .arg(json.scanNs / 1e6 / SCAN_ROUNDS, 20, 'f', 3)
+               .arg(trimmed.scanNs / 1e6 / SCAN_ROUNDS, 20, 'f', 3)
+               .arg(model.scanNs / 1e6 / SCAN_ROUNDS, 20, 'f', 3) << "\n";
+    out << "\nModel: " << model.poolStrings << " napisów w puli, bloki areny serii "
+        << formatMemory(model.arenaBytes) << "\n";
+    out << "Suma kontrolna (JSON pełny / JSON te same pola / model): " << json.checksum << " / "
+        << trimmed.checksum << " / " << model.checksum << "\n";
+    return 0;
+}
@@ -3,15 +3,60 @@
  * @brief Główny plik uruchamiający aplikację.
  *
  * Ten plik zawiera kod inicjujący aplikację Qt oraz uruchamiający główne okno aplikacji.
+ * Z opcją `--server` aplikacja działa bez interfejsu graficznego jako lokalny serwer
+ * pośredniczący z cache dla API GIOŚ, na który mogą wskazywać inne instancje (`--base-url`).
  */
 
 #include "mainwindow.h"
+#include "proxyserver.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QScopedPointer>
 
 int main(int argc, char *argv[])
 {
-    QApplication a(argc, argv);
+    // Tryb serwera nie potrzebuje GUI, więc rodzaj aplikacji wybieramy przed jej utworzeniem
+    bool serverMode = false;
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--server") == 0)
+            serverMode = true;
+    }
+
+    QScopedPointer<QCoreApplication> app(serverMode ? new QCoreApplication(argc, argv)
+                                                    : new QApplication(argc, argv));
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption serverOption("server", "Uruchamia lokalny serwer pośredniczący z cache dla API GIOŚ.");
+    QCommandLineOption portOption("port", "Port serwera pośredniczącego (domyślnie 8080).", "port", "8080");
+    QCommandLineOption ttlOption("ttl", "Czas ważności cache serwera w sekundach (domyślnie 300).", "sekundy", "300");
+    QCommandLineOption baseUrlOption("base-url", "Adres bazowy API, np. http://serwer:8080/pjp-api/rest/.",
+                                     "url", "https://api.gios.gov.pl/pjp-api/rest/");
+    parser.addOptions({serverOption, portOption, ttlOption, baseUrlOption});
+    parser.process(*app);
+
+    if (serverMode) {
+        bool portOk = false;
+        quint16 port = parser.value(portOption).toUShort(&portOk);
+        if (!portOk || port == 0) {
+            qWarning("Nieprawidłowy numer portu: %s", qPrintable(parser.value(portOption)));
+            return 1;
+        }
+
+        bool ttlOk = false;
+        int ttl = parser.value(ttlOption).toInt(&ttlOk);
+        if (!ttlOk || ttl <= 0) {
+            qWarning("Nieprawidłowy czas ważności cache: %s", qPrintable(parser.value(ttlOption)));
+            return 1;
+        }
+        ProxyServer server(QUrl(parser.value(baseUrlOption)), ttl);
+        if (!server.listen(QHostAddress::Any, port))
+            return 1;
+        return app->exec();
+    }
+
     MainWindow w;
+    w.setApiBaseUrl(QUrl(parser.value(baseUrlOption)));
     w.show();
-    return a.exec();
+    return app->exec();
 }
@@ -20,12 +20,33 @@
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QDateTimeAxis>
 #include <QDateTime>
+#include <QDataStream>
+#include <QEvent>
+#include <QSaveFile>
+#include <QSignalBlocker>
+#include <QTimer>
+
+/// Nazwa pliku migawki ostatniej sesji.
+static const char *const SNAPSHOT_FILE = "snapshot.dat";
+/// Znacznik pliku migawki ("AQMS").
+static const quint32 SNAPSHOT_MAGIC = 0x41514D53;
+/// Wersja formatu migawki.
+static const quint16 SNAPSHOT_VERSION = 1;
+/// Domyślny adres bazowy API GIOŚ.
+static const char *const DEFAULT_API_BASE_URL = "https://api.gios.gov.pl/pjp-api/rest/";
+/// Czas oczekiwania przed ponownym połączeniem ze strumieniem zdarzeń serwera pośredniczącego.
+static const int EVENTS_RECONNECT_MS = 10000;
+/// Atrybut zapytania z identyfikatorem stacji lub czujnika, którego dotyczy zapytanie.
+static const QNetworkRequest::Attribute REQUEST_ID_ATTRIBUTE =
+    QNetworkRequest::Attribute(QNetworkRequest::User + 1);
 
 /**
  * @brief Konstruktor klasy MainWindow
  *
  * Inicjalizuje interfejs użytkownika oraz konfiguracje związane z menedżerem sieciowym.
- * Tworzy wykres, ustawia antyaliasing oraz dodaje go do layoutu.
+ * Przywraca stan ostatniej sesji z migawki, a budowę wykresu i odświeżenie danych
+ * z API odkłada do momentu pierwszego narysowania okna, aby okno od razu pokazało dane.
+ * Do tego czasu miejsce wykresu w layoucie zajmuje pusty widżet zastępczy.
  *
  * - `statusLabel`: Pokazuje status działania aplikacji.
  * - `connectionStatusLabel`: Informuje o połączeniu z internetem/API.
@@ -39,22 +60,13 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , networkManager(new QNetworkAccessManager(this)) // Inicjalizacja menedżera sieciowego
+    , apiBaseUrl(DEFAULT_API_BASE_URL)
 {
     ui->setupUi(this);
 
-    // Tworzenie obiektu wykresu i przypisanie antyaliasingu
-    QChartView *chartView = new QChartView();
-    chartView->setRenderHint(QPainter::Antialiasing);
-
-    // Nadanie obiektowi wykresu unikalnej nazwy
-    chartView->setObjectName("chartView");
-
-    // Tworzenie wykresu i przypisanie go do chartView
-    QChart *chart = new QChart();
-    chartView->setChart(chart);
-
-    // Dodanie wykresu do layoutu w interfejsie
-    ui->gridLayout->addWidget(chartView);
+    // Widżet zastępczy rezerwuje miejsce na wykres, aby layout nie przeskakiwał po jego utworzeniu
+    chartPlaceholder = new QWidget();
+    ui->gridLayout->addWidget(chartPlaceholder);
 
     // Połączenie sygnału zakończenia zapytania sieciowego z odpowiednim slotem
     connect(networkManager, &QNetworkAccessManager::finished,
@@ -63,15 +75,81 @@ MainWindow::MainWindow(QWidget *parent)
     // Połączenie zmiany wybranego czujnika z odpowiednim slotem
     connect(ui->sensorComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::on_sensorComboBox_currentIndexChanged);
+
+    // Szybki start – przywrócenie listy stacji, czujników i analizy z ostatniej sesji
+    if (loadSnapshot()) {
+        ui->statusLabel->setText("Dane z ostatniej sesji – odświeżanie w tle...");
+    }
+
+    // Wykres i dane z API dopiero po pierwszym narysowaniu okna
+    ui->centralwidget->installEventFilter(this);
+}
+
+/**
+ * @brief Wykrywa pierwsze narysowanie okna.
+ *
+ * Po pierwszym zdarzeniu Paint centralnego widżetu kolejkuje startDeferredWork(),
+ * które wykona się dopiero po zakończeniu bieżącego rysowania.
+ *
+ * @param watched Obserwowany obiekt
+ * @param event Zdarzenie
+ * @return Zawsze false – zdarzenie jest przekazywane dalej
+ */
+bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == ui->centralwidget && event->type() == QEvent::Paint) {
+        ui->centralwidget->removeEventFilter(this);
+        QTimer::singleShot(0, this, &MainWindow::startDeferredWork);
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
+/**
+ * @brief Wykonuje prace odłożone do momentu pierwszego narysowania okna.
+ *
+ * Buduje wykres z serii przywróconej z migawki i uruchamia odświeżanie danych w tle.
+ * Przy serwerze pośredniczącym subskrybuje też jego powiadomienia o odświeżonych danych.
+ */
+void MainWindow::startDeferredWork() {
+    if (!lastSeries.isEmpty()) {
+        updateChart(lastParamName, lastSeries);
+    }
+    refreshInBackground();
+    if (usesProxy())
+        subscribeToEvents();
+}
+
+/**
+ * @brief Ustawia adres bazowy API.
+ *
+ * Pozwala wskazać lokalny serwer pośredniczący (tryb `--server`) zamiast API GIOŚ.
+ * Brakujący ukośnik na końcu adresu jest dopisywany.
+ *
+ * @param url Adres bazowy, np. `http://localhost:8080/pjp-api/rest/`
+ */
+void MainWindow::setApiBaseUrl(const QUrl &url) {
+    apiBaseUrl = url;
+    if (!apiBaseUrl.path().endsWith('/'))
+        apiBaseUrl.setPath(apiBaseUrl.path() + '/');
+}
+
+/**
+ * @brief Buduje pełny adres zapytania do API.
+ *
+ * @param path Ścieżka względem adresu bazowego (np. "station/findAll")
+ * @return Pełny adres URL
+ */
+QUrl MainWindow::apiUrl(const QString &path) const {
+    return apiBaseUrl.resolved(QUrl(path));
 }
 
 /**
  * @brief Destruktor klasy MainWindow
  *
- * Zwalnia zasoby związane z interfejsem użytkownika.
+ * Zapisuje migawkę sesji i zwalnia zasoby związane z interfejsem użytkownika.
  */
 MainWindow::~MainWindow()
 {
+    saveSnapshot();
     delete ui;
 }
 
@@ -79,13 +157,14 @@ MainWindow::~MainWindow()
  * @brief Obsługuje kliknięcie przycisku "Pobierz dane"
  *
  * Sprawdza dostępność internetu i API GIOŚ. W zależności od dostępności pobiera dane z sieci lub z plików lokalnych.
+ * Dostępność sprawdzana jest raz – wynik aktualizacji statusu decyduje o wyborze źródła danych.
  */
 void MainWindow::on_fetchDataButton_clicked() {
-    updateOnlineStatus();
+    bool online = updateOnlineStatus();
 
-    if (isInternetAvailable()) {
+    if (online) {
         // Pobieranie listy stacji
-        QUrl url("https://api.gios.gov.pl/pjp-api/rest/station/findAll");
+        QUrl url = apiUrl("station/findAll");
         QNetworkRequest request(url);
         request.setAttribute(QNetworkRequest::User, "stations");
         networkManager->get(request);
@@ -93,9 +172,10 @@ void MainWindow::on_fetchDataButton_clicked() {
         // Pobieranie danych z wybranego czujnika
         int sensorId = ui->sensorComboBox->currentData().toInt();
         if (sensorId != 0) {
-            QUrl url1("https://api.gios.gov.pl/pjp-api/rest/data/getData/" + QString::number(sensorId));
+            QUrl url1 = apiUrl("data/getData/" + QString::number(sensorId));
             QNetworkRequest request1(url1);
             request1.setAttribute(QNetworkRequest::User, "measurements");
+            request1.setAttribute(REQUEST_ID_ATTRIBUTE, sensorId);
             networkManager->get(request1);
         }
     } else {
@@ -120,25 +200,47 @@ void MainWindow::on_fetchDataButton_clicked() {
  *
  * Przetwarza odpowiedź na podstawie typu zapytania (stacje, czujniki, pomiary),
  * zapisuje dane do plików lokalnych i wywołuje odpowiednią funkcję do analizy danych.
+ * Po odebraniu nowych pomiarów aktualizuje migawkę sesji. Odpowiedzi z błędem są pomijane,
+ * podobnie jak odpowiedzi o czujniki lub pomiary stacji albo czujnika, który nie jest już
+ * wybrany (użytkownik zmienił wybór, zanim odpowiedź dotarła).
  *
  * @param reply Odpowiedź na zapytanie sieciowe
  */
 void MainWindow::onNetworkReplyFinished(QNetworkReply *reply) {
     QByteArray responseData = reply->readAll();
     QString requestType = reply->request().attribute(QNetworkRequest::User).toString();
+    int requestId = reply->request().attribute(REQUEST_ID_ATTRIBUTE).toInt();
+
+    // Strumień zdarzeń zakończony (np. restart serwera pośredniczącego) – ponowne połączenie po chwili
+    if (requestType == "events") {
+        eventsBuffer.clear();
+        QTimer::singleShot(EVENTS_RECONNECT_MS, this, &MainWindow::subscribeToEvents);
+        reply->deleteLater();
+        return;
+    }
+
+    // Przy błędzie zostawiamy dotychczasowe dane (cache, migawka) bez zmian
+    if (!requestType.isEmpty() && reply->error() != QNetworkReply::NoError) {
+        ui->statusLabel->setText("Nie udało się odświeżyć danych – wyświetlane są dane zapisane lokalnie.");
+        reply->deleteLater();
+        return;
+    }
 
     // Przetwarzanie odpowiedzi w zależności od typu zapytania
     if (requestType == "stations") {
         parseStationData(responseData);
         saveDataToFile("stations", responseData);
     } else if (requestType == "sensors") {
-        parseSensorData(responseData);
-        int stationId = ui->stationComboBox->currentData().toInt();
-        saveDataToFile("sensors_" + QString::number(stationId), responseData);
+        // Zapisujemy pod identyfikatorem z zapytania, ale pokazujemy tylko dla wybranej stacji
+        saveDataToFile("sensors_" + QString::number(requestId), responseData);
+        if (requestId == ui->stationComboBox->currentData().toInt())
+            parseSensorData(responseData);
     } else if (requestType == "measurements") {
-        parseMeasurementData(responseData);
-        int sensorId = ui->sensorComboBox->currentData().toInt();
-        saveDataToFile("measurements_" + QString::number(sensorId), responseData);
+        saveDataToFile("measurements_" + QString::number(requestId), responseData);
+        if (requestId == ui->sensorComboBox->currentData().toInt()) {
+            parseMeasurementData(responseData);
+            saveSnapshot();
+        }
     }
 
     reply->deleteLater(); // Zwolnienie pamięci
@@ -149,6 +251,7 @@ void MainWindow::onNetworkReplyFinished(QNetworkReply *reply) {
  *
  * Przy zmianie wybranej stacji pobiera dane czujników stacji z internetu lub z plików lokalnych,
  * jeżeli tryb offline jest aktywowany.
+ * Lista czujników poprzedniej stacji jest od razu czyszczona.
  *
  * @param index Indeks wybranej stacji
  */
@@ -158,10 +261,17 @@ void MainWindow::on_stationComboBox_currentIndexChanged(int index) {
     int stationId = ui->stationComboBox->itemData(index).toInt();
     ui->statusLabel->setText("Pobieranie czujników dla stacji ID: " + QString::number(stationId));
 
-    if (isInternetAvailable()) {
-        QUrl url("https://api.gios.gov.pl/pjp-api/rest/station/sensors/" + QString::number(stationId));
+    // Czujniki poprzedniej stacji nie mogą pozostać wybrane – spóźnione pomiary zostałyby przypisane tej stacji
+    {
+        QSignalBlocker blocker(ui->sensorComboBox);
+        ui->sensorComboBox->clear();
+    }
+
+    if (isDataSourceAvailable()) {
+        QUrl url = apiUrl("station/sensors/" + QString::number(stationId));
         QNetworkRequest request(url);
         request.setAttribute(QNetworkRequest::User, "sensors");
+        request.setAttribute(REQUEST_ID_ATTRIBUTE, stationId);
         networkManager->get(request);
     } else {
         QByteArray data = loadDataFromFile("sensors_" + QString::number(stationId));
@@ -169,7 +279,6 @@ void MainWindow::on_stationComboBox_currentIndexChanged(int index) {
             parseSensorData(data);
         } else {
             ui->statusLabel->setText("Brak zapisanych danych o czujnikach dla tej stacji.");
-            ui->sensorComboBox->clear();
         }
     }
 }
@@ -188,10 +297,11 @@ void MainWindow::on_sensorComboBox_currentIndexChanged(int index) {
     int sensorId = ui->sensorComboBox->itemData(index).toInt();
     ui->statusLabel->setText("Pobieranie danych pomiarowych dla czujnika ID: " + QString::number(sensorId));
 
-    if (isInternetAvailable()) {
-        QUrl url("https://api.gios.gov.pl/pjp-api/rest/data/getData/" + QString::number(sensorId));
+    if (isDataSourceAvailable()) {
+        QUrl url = apiUrl("data/getData/" + QString::number(sensorId));
         QNetworkRequest request(url);
         request.setAttribute(QNetworkRequest::User, "measurements");
+        request.setAttribute(REQUEST_ID_ATTRIBUTE, sensorId);
         networkManager->get(request);
     } else {
         QByteArray data = loadDataFromFile("measurements_" + QString::number(sensorId));
@@ -202,7 +312,8 @@ void MainWindow::on_sensorComboBox_currentIndexChanged(int index) {
             ui->analysisTextEdit->setPlainText("");
 
             // Czyszczenie wykresu, jeśli dane są niedostępne
-            QChartView *chartView = findChild<QChartView*>("chartView");
+            lastParamName.clear();
+            lastSeries.clear();
             if (chartView) {
                 chartView->setChart(new QChart()); // czyści wykres
             }
@@ -259,7 +370,7 @@ QByteArray MainWindow::loadDataFromFile(const QString &type) {
  * @return true, jeśli API jest dostępne (brak błędów w odpowiedzi), w przeciwnym przypadku false.
  */
 bool MainWindow::isApiAvailable() {
-    QNetworkRequest request(QUrl("https://api.gios.gov.pl/pjp-api/rest/station/findAll"));
+    QNetworkRequest request(apiUrl("station/findAll"));
     QNetworkReply *reply = networkManager->get(request);
 
     QEventLoop loop;
@@ -296,15 +407,56 @@ bool MainWindow::isInternetAvailable() {
     }
 }
 
+/**
+ * @brief Sprawdza, czy źródło danych jest osiągalne.
+ *
+ * Przy domyślnym API GIOŚ sprawdzana jest dostępność internetu. Gdy adres bazowy
+ * wskazuje serwer pośredniczący, sprawdzany jest bezpośrednio ten serwer – ekran
+ * w sieci lokalnej może nie mieć dostępu do internetu, a mimo to korzystać z serwera.
+ *
+ * @return true, jeśli dane można pobrać z sieci, w przeciwnym przypadku false.
+ */
+bool MainWindow::isDataSourceAvailable() {
+    if (usesProxy())
+        return isApiAvailable();
+    return isInternetAvailable();
+}
+
+/**
+ * @brief Sprawdza, czy adres bazowy wskazuje serwer pośredniczący.
+ *
+ * @return true, jeśli adres bazowy jest inny niż domyślny adres API GIOŚ.
+ */
+bool MainWindow::usesProxy() const {
+    return apiBaseUrl != QUrl(DEFAULT_API_BASE_URL);
+}
+
 /**
  * @brief Aktualizuje status połączenia w interfejsie użytkownika.
  *
  * Funkcja sprawdza dostępność internetu i dostępność API GIOŚ. Na podstawie tych
  * informacji aktualizuje tekst i kolor etykiety statusu połączenia w interfejsie użytkownika.
  * Etykieta zmienia kolor na zielony, pomarańczowy lub czerwony w zależności od stanu połączenia.
+ * Przy serwerze pośredniczącym sprawdzany jest tylko ten serwer.
+ *
+ * @return true, jeśli źródło danych jest osiągalne: serwer pośredniczący, a przy
+ * domyślnym API GIOŚ – internet (tak samo jak w isDataSourceAvailable()).
  */
-void MainWindow::updateOnlineStatus() {
-    if (isInternetAvailable()) {
+bool MainWindow::updateOnlineStatus() {
+    if (usesProxy()) {
+        bool proxyAvailable = isApiAvailable();
+        if (proxyAvailable) {
+            ui->connectionStatusLabel->setText("Online (serwer pośredniczący dostępny)");
+            ui->connectionStatusLabel->setStyleSheet("QLabel { color : green; }");
+        } else {
+            ui->connectionStatusLabel->setText("Offline (serwer pośredniczący niedostępny)");
+            ui->connectionStatusLabel->setStyleSheet("QLabel { color : red; }");
+        }
+        return proxyAvailable;
+    }
+
+    bool internetAvailable = isInternetAvailable();
+    if (internetAvailable) {
         if (isApiAvailable()) {
             ui->connectionStatusLabel->setText("Online (strona dostępna)");
             ui->connectionStatusLabel->setStyleSheet("QLabel { color : green; }");
@@ -316,6 +468,7 @@ void MainWindow::updateOnlineStatus() {
         ui->connectionStatusLabel->setText("Offline (brak internetu)");
         ui->connectionStatusLabel->setStyleSheet("QLabel { color : red; }");
     }
+    return internetAvailable;
 }
 
 /**
@@ -323,7 +476,9 @@ void MainWindow::updateOnlineStatus() {
  *
  * Funkcja odbiera dane w formacie JSON, konwertuje je na tablicę, a następnie
  * dodaje nazwy stacji do listy w ComboBoxie, przypisując jednocześnie ich identyfikatory
- * jako dane powiązane z elementami listy.
+ * jako dane powiązane z elementami listy. Dotychczas wybrana stacja pozostaje wybrana;
+ * czujniki są pobierane ponownie tylko wtedy, gdy wybór stacji się zmienił
+ * lub lista czujników jest pusta.
  *
  * @param data Dane stacji w formacie JSON.
  */
@@ -331,17 +486,27 @@ void MainWindow::parseStationData(const QByteArray &data) {
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (!doc.isArray()) return;
 
-    ui->stationComboBox->clear();
+    int previousId = ui->stationComboBox->currentData().toInt();
+    {
+        QSignalBlocker blocker(ui->stationComboBox);
+        ui->stationComboBox->clear();
+
+        QJsonArray array = doc.array();
+        for (const QJsonValue &val : array) {
+            QJsonObject obj = val.toObject();
+            int id = obj["id"].toInt();
+            QString name = obj["stationName"].toString();
+            ui->stationComboBox->addItem(name, id);
+        }
 
-    QJsonArray array = doc.array();
-    for (const QJsonValue &val : array) {
-        QJsonObject obj = val.toObject();
-        int id = obj["id"].toInt();
-        QString name = obj["stationName"].toString();
-        ui->stationComboBox->addItem(name, id);
+        int index = ui->stationComboBox->findData(previousId);
+        if (index >= 0)
+            ui->stationComboBox->setCurrentIndex(index);
     }
 
-    if (ui->stationComboBox->count() > 0)
+    // Czujniki ładujemy, gdy zmieniła się stacja lub lista czujników jest pusta (np. tryb offline)
+    if (ui->stationComboBox->count() > 0
+        && (ui->stationComboBox->currentData().toInt() != previousId || ui->sensorComboBox->count() == 0))
         on_stationComboBox_currentIndexChanged(ui->stationComboBox->currentIndex());
 
 }
@@ -351,7 +516,8 @@ void MainWindow::parseStationData(const QByteArray &data) {
  *
  * Funkcja przetwarza dane czujników w formacie JSON, wydobywa nazwę parametru
  * i dodaje je do listy w ComboBoxie, przypisując odpowiednie identyfikatory
- * czujników jako dane powiązane z elementami listy.
+ * czujników jako dane powiązane z elementami listy. Dotychczas wybrany czujnik
+ * pozostaje wybrany; pomiary są pobierane tylko wtedy, gdy wybór czujnika się zmienił.
  *
  * @param data Dane czujników w formacie JSON.
  */
@@ -359,15 +525,26 @@ void MainWindow::parseSensorData(const QByteArray &data) {
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (!doc.isArray()) return;
 
-    ui->sensorComboBox->clear();
+    int previousId = ui->sensorComboBox->currentData().toInt();
+    {
+        QSignalBlocker blocker(ui->sensorComboBox);
+        ui->sensorComboBox->clear();
+
+        QJsonArray array = doc.array();
+        for (const QJsonValue &val : array) {
+            QJsonObject obj = val.toObject();
+            int id = obj["id"].toInt();
+            QString param = obj["param"].toObject()["paramName"].toString();
+            ui->sensorComboBox->addItem(param, id);
+        }
 
-    QJsonArray array = doc.array();
-    for (const QJsonValue &val : array) {
-        QJsonObject obj = val.toObject();
-        int id = obj["id"].toInt();
-        QString param = obj["param"].toObject()["paramName"].toString();
-        ui->sensorComboBox->addItem(param, id);
+        int index = ui->sensorComboBox->findData(previousId);
+        if (index >= 0)
+            ui->sensorComboBox->setCurrentIndex(index);
     }
+
+    if (ui->sensorComboBox->count() > 0 && ui->sensorComboBox->currentData().toInt() != previousId)
+        on_sensorComboBox_currentIndexChanged(ui->sensorComboBox->currentIndex());
 }
 
 /**
@@ -389,8 +566,8 @@ void MainWindow::parseMeasurementData(const QByteArray &data) {
     QString paramName = rootObj["key"].toString();
 
     QJsonArray values = rootObj["values"].toArray();
-    QLineSeries *series = new QLineSeries();
-    series->setName(paramName);  // dodajemy nazwę do legendy
+    QList<QPointF> points;
+    points.reserve(values.size());
 
     QStringList analysisTextList;
 
@@ -401,13 +578,57 @@ void MainWindow::parseMeasurementData(const QByteArray &data) {
 
         if (value >= 0) {
             QDateTime timestamp = QDateTime::fromString(dateStr, Qt::ISODate);
-            series->append(timestamp.toMSecsSinceEpoch(), value);
+            points.append(QPointF(timestamp.toMSecsSinceEpoch(), value));
 
             // Linia tekstowa z datą i wartością
             analysisTextList.append(timestamp.toString("dd.MM.yyyy HH:mm") + " → " + QString::number(value, 'f', 2));
         }
     }
 
+    lastParamName = paramName;
+    lastSeries = points;
+    updateChart(paramName, points);
+
+    // Wyświetlamy dane pomiarowe w analysisTextEdit
+    ui->analysisTextEdit->setPlainText(analysisTextList.join("\n"));
+
+    performDataAnalysis(values);
+}
+
+/**
+ * @brief Zwraca widok wykresu, tworząc go przy pierwszym wywołaniu.
+ *
+ * Tworzy QChartView z antyaliasingiem i wstawia go w miejsce widżetu zastępczego dopiero wtedy,
+ * gdy jest potrzebny, dzięki czemu pierwsze wyświetlenie okna nie czeka na budowę wykresu.
+ *
+ * @return Wskaźnik do widoku wykresu.
+ */
+QChartView *MainWindow::ensureChartView() {
+    if (!chartView) {
+        chartView = new QChartView();
+        chartView->setRenderHint(QPainter::Antialiasing);
+        chartView->setObjectName("chartView");
+        chartView->setChart(new QChart());
+        delete ui->gridLayout->replaceWidget(chartPlaceholder, chartView);
+        delete chartPlaceholder;
+        chartPlaceholder = nullptr;
+    }
+    return chartView;
+}
+
+/**
+ * @brief Rysuje serię pomiarową na wykresie.
+ *
+ * Tworzy nowy wykres z osią czasu i osią wartości, a następnie podmienia go w widoku wykresu.
+ *
+ * @param paramName Nazwa parametru wyświetlana w tytule i legendzie.
+ * @param points Punkty (czas w ms od epoki, wartość) do narysowania.
+ */
+void MainWindow::updateChart(const QString &paramName, const QList<QPointF> &points) {
+    QLineSeries *series = new QLineSeries();
+    series->setName(paramName);  // dodajemy nazwę do legendy
+    series->append(points);
+
     // Wykres
     QChart *chart = new QChart();
     chart->addSeries(series);
@@ -428,17 +649,7 @@ void MainWindow::parseMeasurementData(const QByteArray &data) {
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
 
-    // Znajdujemy dynamicznie utworzony chartView
-    QChartView *chartView = findChild<QChartView*>("chartView");
-    if (chartView) {
-        chartView->setChart(chart);
-        chartView->setRenderHint(QPainter::Antialiasing);
-    }
-
-    // Wyświetlamy dane pomiarowe w analysisTextEdit
-    ui->analysisTextEdit->setPlainText(analysisTextList.join("\n"));
-
-    performDataAnalysis(values);
+    ensureChartView()->setChart(chart);
 }
 
 /**
@@ -508,3 +719,216 @@ void MainWindow::performDataAnalysis(const QJsonArray &valuesArray) { // Analiza
 
     ui->dataAnalysisLineEdit->setText(result);
 }
+
+/**
+ * @brief Zapisuje migawkę bieżącej sesji.
+ *
+ * Zapisuje do pliku `snapshot.dat` w bieżącym katalogu listę stacji i czujników,
+ * identyfikatory wybranej stacji i czujnika, ostatnią serię pomiarową oraz teksty analizy.
+ * Plik zapisywany jest atomowo, więc przerwany zapis nie psuje poprzedniej migawki.
+ * Jeśli lista stacji jest pusta (nic nie zostało wczytane), poprzednia migawka pozostaje bez zmian.
+ */
+void MainWindow::saveSnapshot() {
+    if (ui->stationComboBox->count() == 0)
+        return;
+
+    QString filename = QDir::currentPath() + "/" + SNAPSHOT_FILE;
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Nie udało się zapisać migawki do pliku: %s", qPrintable(filename));
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+
+    out << qint32(ui->stationComboBox->count());
+    for (int i = 0; i < ui->stationComboBox->count(); ++i)
+        out << qint32(ui->stationComboBox->itemData(i).toInt()) << ui->stationComboBox->itemText(i);
+    out << qint32(ui->stationComboBox->currentIndex());
+
+    out << qint32(ui->sensorComboBox->count());
+    for (int i = 0; i < ui->sensorComboBox->count(); ++i)
+        out << qint32(ui->sensorComboBox->itemData(i).toInt()) << ui->sensorComboBox->itemText(i);
+    out << qint32(ui->sensorComboBox->currentIndex());
+
+    out << lastParamName << lastSeries;
+    out << ui->analysisTextEdit->toPlainText() << ui->dataAnalysisLineEdit->text();
+
+    if (!file.commit())
+        qWarning("Nie udało się zapisać migawki do pliku: %s", qPrintable(filename));
+}
+
+/**
+ * @brief Przywraca interfejs z migawki ostatniej sesji.
+ *
+ * Odczytuje plik `snapshot.dat` i wypełnia listy stacji i czujników oraz pola analizy.
+ * Sygnały list są blokowane, aby przywracanie nie wywoływało zapytań sieciowych.
+ * Wykres nie jest tu budowany – seria trafia do `lastSeries` i jest rysowana później.
+ *
+ * @return true, jeśli migawka została wczytana i zawiera stacje, w przeciwnym razie false.
+ */
+bool MainWindow::loadSnapshot() {
+    QFile file(QDir::currentPath() + "/" + SNAPSHOT_FILE);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+        return false;
+
+    QList<QPair<qint32, QString>> stations, sensors;
+    qint32 count = 0, stationIndex = -1, sensorIndex = -1;
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QPair<qint32, QString> item;
+        in >> item.first >> item.second;
+        stations.append(item);
+    }
+    in >> stationIndex;
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QPair<qint32, QString> item;
+        in >> item.first >> item.second;
+        sensors.append(item);
+    }
+    in >> sensorIndex;
+
+    QString paramName, analysisText, analysisLine;
+    QList<QPointF> series;
+    in >> paramName >> series >> analysisText >> analysisLine;
+
+    if (in.status() != QDataStream::Ok || stations.isEmpty())
+        return false;
+
+    {
+        QSignalBlocker stationBlocker(ui->stationComboBox);
+        QSignalBlocker sensorBlocker(ui->sensorComboBox);
+
+        ui->stationComboBox->clear();
+        for (const auto &item : stations)
+            ui->stationComboBox->addItem(item.second, item.first);
+        ui->stationComboBox->setCurrentIndex(stationIndex);
+
+        ui->sensorComboBox->clear();
+        for (const auto &item : sensors)
+            ui->sensorComboBox->addItem(item.second, item.first);
+        ui->sensorComboBox->setCurrentIndex(sensorIndex);
+    }
+
+    lastParamName = paramName;
+    lastSeries = series;
+    ui->analysisTextEdit->setPlainText(analysisText);
+    ui->dataAnalysisLineEdit->setText(analysisLine);
+    return true;
+}
+
+/**
+ * @brief Odświeża dane w tle.
+ *
+ * Wysyła asynchroniczne zapytania o listę stacji, czujniki wybranej stacji oraz pomiary
+ * wybranego czujnika. Nie sprawdza wcześniej połączenia – jeśli API jest niedostępne,
+ * odpowiedzi z błędem są pomijane, a w oknie pozostają dane z migawki.
+ */
+void MainWindow::refreshInBackground() {
+    QNetworkRequest stationsRequest(apiUrl("station/findAll"));
+    stationsRequest.setAttribute(QNetworkRequest::User, "stations");
+    networkManager->get(stationsRequest);
+
+    int stationId = ui->stationComboBox->currentData().toInt();
+    if (stationId != 0) {
+        QNetworkRequest sensorsRequest(apiUrl("station/sensors/" + QString::number(stationId)));
+        sensorsRequest.setAttribute(QNetworkRequest::User, "sensors");
+        sensorsRequest.setAttribute(REQUEST_ID_ATTRIBUTE, stationId);
+        networkManager->get(sensorsRequest);
+    }
+
+    int sensorId = ui->sensorComboBox->currentData().toInt();
+    if (sensorId != 0) {
+        QNetworkRequest measurementsRequest(apiUrl("data/getData/" + QString::number(sensorId)));
+        measurementsRequest.setAttribute(QNetworkRequest::User, "measurements");
+        measurementsRequest.setAttribute(REQUEST_ID_ATTRIBUTE, sensorId);
+        networkManager->get(measurementsRequest);
+    }
+}
+
+/**
+ * @brief Subskrybuje strumień zdarzeń serwera pośredniczącego.
+ *
+ * Połączenie pozostaje otwarte; dane odczytuje onEventsReadyRead(). Po jego zakończeniu
+ * onNetworkReplyFinished() ponawia subskrypcję po `EVENTS_RECONNECT_MS` milisekundach.
+ */
+void MainWindow::subscribeToEvents() {
+    QNetworkRequest request(apiUrl("events"));
+    request.setAttribute(QNetworkRequest::User, "events");
+    request.setRawHeader("Accept", "text/event-stream");
+    QNetworkReply *reply = networkManager->get(request);
+    connect(reply, &QNetworkReply::readyRead, this, &MainWindow::onEventsReadyRead);
+}
+
+/**
+ * @brief Odczytuje kolejne dane strumienia zdarzeń serwera pośredniczącego.
+ *
+ * Zdarzenia Server-Sent Events oddzielone są pustą linią; niepełne zdarzenie czeka
+ * w `eventsBuffer` na dalsze dane. Komentarze (np. `: ping`) są pomijane.
+ */
+void MainWindow::onEventsReadyRead() {
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) return;
+
+    eventsBuffer += reply->readAll();
+
+    qsizetype end;
+    while ((end = eventsBuffer.indexOf("\n\n")) >= 0) {
+        QByteArray block = eventsBuffer.left(end);
+        eventsBuffer.remove(0, end + 2);
+
+        QByteArray eventName, data;
+        for (const QByteArray &line : block.split('\n')) {
+            if (line.startsWith("event:"))
+                eventName = line.mid(6).trimmed();
+            else if (line.startsWith("data:"))
+                data = line.mid(5).trimmed();
+        }
+
+        if (eventName == "update")
+            handleUpdateEvent(data);
+    }
+}
+
+/**
+ * @brief Obsługuje zdarzenie `update` serwera pośredniczącego.
+ *
+ * Ponownie pobiera listę stacji, czujniki wybranej stacji lub pomiary wybranego czujnika,
+ * jeśli odświeżona została odpowiadająca im ścieżka. Serwer odpowie wtedy z cache,
+ * więc ekrany odświeżają się bez dodatkowych zapytań do API GIOŚ. Pozostałe ścieżki są pomijane.
+ *
+ * @param data Treść pola `data` zdarzenia (JSON ze ścieżką).
+ */
+void MainWindow::handleUpdateEvent(const QByteArray &data) {
+    QString path = QJsonDocument::fromJson(data).object()["path"].toString();
+    int stationId = ui->stationComboBox->currentData().toInt();
+    int sensorId = ui->sensorComboBox->currentData().toInt();
+
+    QNetworkRequest request(apiUrl(path));
+    if (path == "station/findAll") {
+        request.setAttribute(QNetworkRequest::User, "stations");
+    } else if (stationId != 0 && path == "station/sensors/" + QString::number(stationId)) {
+        request.setAttribute(QNetworkRequest::User, "sensors");
+        request.setAttribute(REQUEST_ID_ATTRIBUTE, stationId);
+    } else if (sensorId != 0 && path == "data/getData/" + QString::number(sensorId)) {
+        request.setAttribute(QNetworkRequest::User, "measurements");
+        request.setAttribute(REQUEST_ID_ATTRIBUTE, sensorId);
+    } else {
+        return;
+    }
+    networkManager->get(request);
+}
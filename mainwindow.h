@@ -30,11 +30,14 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QTextStream>
+#include <QList>
+#include <QPointF>
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
 class MainWindow;
 }
+class QChartView;
 QT_END_NAMESPACE
 
 /**
@@ -66,9 +69,109 @@ public:
      */
     ~MainWindow();
 
+    /**
+     * @brief Ustawia adres bazowy API.
+     *
+     * Domyślnie używane jest API GIOŚ; można wskazać lokalny serwer pośredniczący.
+     *
+     * @param url Adres bazowy, np. `http://localhost:8080/pjp-api/rest/`.
+     */
+    void setApiBaseUrl(const QUrl &url);
+
+protected:
+    /**
+     * @brief Wykrywa pierwsze narysowanie okna.
+     *
+     * @param watched Obserwowany obiekt.
+     * @param event Zdarzenie.
+     * @return false – zdarzenie jest zawsze przekazywane dalej.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private:
     Ui::MainWindow *ui; /**< Wskaźnik do interfejsu użytkownika */
     QNetworkAccessManager *networkManager; /**< Menedżer sieciowy do obsługi zapytań HTTP */
+    QUrl apiBaseUrl; /**< Adres bazowy API (GIOŚ lub lokalny serwer pośredniczący) */
+    QChartView *chartView = nullptr; /**< Widok wykresu tworzony dopiero przy pierwszym użyciu */
+    QWidget *chartPlaceholder = nullptr; /**< Widżet zastępczy zajmujący miejsce wykresu do czasu jego utworzenia */
+    QString lastParamName; /**< Nazwa parametru ostatnio wyświetlonej serii pomiarowej */
+    QList<QPointF> lastSeries; /**< Punkty (czas w ms, wartość) ostatnio wyświetlonej serii */
+    QByteArray eventsBuffer; /**< Nieprzetworzona część strumienia zdarzeń serwera pośredniczącego */
+
+    /**
+     * @brief Buduje pełny adres zapytania do API.
+     *
+     * @param path Ścieżka względem adresu bazowego (np. "station/findAll").
+     * @return Pełny adres URL.
+     */
+    QUrl apiUrl(const QString &path) const;
+
+    /**
+     * @brief Zwraca widok wykresu, tworząc go przy pierwszym wywołaniu.
+     *
+     * Budowa QChartView jest kosztowna, dlatego odkładana jest do momentu,
+     * w którym wykres ma zostać faktycznie narysowany.
+     *
+     * @return Wskaźnik do widoku wykresu.
+     */
+    QChartView *ensureChartView();
+
+    /**
+     * @brief Rysuje serię pomiarową na wykresie.
+     *
+     * @param paramName Nazwa parametru wyświetlana w tytule i legendzie.
+     * @param points Punkty (czas w ms od epoki, wartość) do narysowania.
+     */
+    void updateChart(const QString &paramName, const QList<QPointF> &points);
+
+    /**
+     * @brief Zapisuje migawkę bieżącej sesji.
+     *
+     * Migawka w formacie binarnym (QDataStream) zawiera listę stacji i czujników,
+     * wybraną stację i czujnik, ostatnią serię pomiarową oraz wyniki analizy.
+     */
+    void saveSnapshot();
+
+    /**
+     * @brief Przywraca interfejs z migawki ostatniej sesji.
+     *
+     * Wypełnia listy stacji i czujników oraz pola analizy bez wysyłania zapytań sieciowych.
+     *
+     * @return true, jeśli migawka została wczytana, w przeciwnym razie false.
+     */
+    bool loadSnapshot();
+
+    /**
+     * @brief Odświeża dane w tle.
+     *
+     * Wysyła asynchroniczne zapytania o stacje, czujniki wybranej stacji oraz pomiary
+     * wybranego czujnika, bez blokującego sprawdzania połączenia.
+     */
+    void refreshInBackground();
+
+    /**
+     * @brief Wykonuje prace odłożone do momentu pierwszego narysowania okna.
+     *
+     * Buduje wykres z migawki i uruchamia odświeżanie danych w tle.
+     */
+    void startDeferredWork();
+
+    /**
+     * @brief Subskrybuje strumień zdarzeń serwera pośredniczącego.
+     *
+     * Otwiera połączenie ze ścieżką `events` (Server-Sent Events). Używane tylko
+     * wtedy, gdy adres bazowy wskazuje serwer pośredniczący.
+     */
+    void subscribeToEvents();
+
+    /**
+     * @brief Obsługuje zdarzenie `update` serwera pośredniczącego.
+     *
+     * Ponownie pobiera odświeżoną ścieżkę, jeśli dotyczy wyświetlanych danych.
+     *
+     * @param data Treść pola `data` zdarzenia (JSON ze ścieżką).
+     */
+    void handleUpdateEvent(const QByteArray &data);
 
     /**
      * @brief Zapisuje dane do pliku JSON.
@@ -99,12 +202,30 @@ private:
      */
     bool isInternetAvailable();
 
+    /**
+     * @brief Sprawdza, czy źródło danych jest osiągalne.
+     *
+     * Dla API GIOŚ sprawdza internet, dla serwera pośredniczącego – sam serwer.
+     *
+     * @return true, jeśli dane można pobrać z sieci, w przeciwnym razie false.
+     */
+    bool isDataSourceAvailable();
+
+    /**
+     * @brief Sprawdza, czy adres bazowy wskazuje serwer pośredniczący.
+     *
+     * @return true, jeśli adres bazowy jest inny niż domyślny adres API GIOŚ.
+     */
+    bool usesProxy() const;
+
     /**
      * @brief Aktualizuje status połączenia w interfejsie użytkownika.
      *
      * Zmienia tekst etykiety statusu połączenia w zależności od dostępności internetu i API.
+     *
+     * @return true, jeśli źródło danych jest osiągalne (jak isDataSourceAvailable()).
      */
-    void updateOnlineStatus();
+    bool updateOnlineStatus();
 
     /**
      * @brief Przetwarza dane stacji pomiarowej.
@@ -168,6 +289,13 @@ private slots:
      */
     void onNetworkReplyFinished(QNetworkReply* reply);
 
+    /**
+     * @brief Odczytuje kolejne dane strumienia zdarzeń serwera pośredniczącego.
+     *
+     * Dzieli strumień na zdarzenia i przekazuje zdarzenia `update` dalej.
+     */
+    void onEventsReadyRead();
+
     /**
      * @brief Obsługuje zmianę wybranej stacji.
      *
@@ -0,0 +1,405 @@
+/**
+ * @file proxyserver.cpp
+ * @brief Definicje metod klasy ProxyServer.
+ *
+ * Ten plik zawiera implementację lokalnego serwera pośredniczącego dla API GIOŚ:
+ * - prostą obsługę HTTP/1.1 (tylko GET) na QTcpServer,
+ * - cache odpowiedzi z okresowym odświeżaniem i usuwaniem nieużywanych ścieżek,
+ * - łączenie jednoczesnych zapytań o tę samą ścieżkę w jedno zapytanie do API,
+ * - powiadomienia Server-Sent Events o odświeżonych danych.
+ */
+
+#include "proxyserver.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMap>
+
+/// Prefiks ścieżek REST zgodny z API GIOŚ.
+static const char *const REST_PREFIX = "/pjp-api/rest/";
+/// Maksymalny rozmiar nagłówków zapytania w bajtach.
+static const int MAX_REQUEST_SIZE = 8192;
+/// Liczba okresów ważności bez odczytu, po której ścieżka jest usuwana z cache.
+static const int IDLE_EVICT_TTLS = 3;
+
+/**
+ * @brief Konstruktor klasy ProxyServer
+ *
+ * Tworzy serwer TCP, menedżer sieciowy do zapytań do API GIOŚ oraz zegar,
+ * który co `cacheTtlSeconds` odświeża dane przechowywane w cache.
+ *
+ * @param upstreamBaseUrl Adres bazowy API GIOŚ (brakujący końcowy ukośnik jest dopisywany)
+ * @param cacheTtlSeconds Czas ważności danych w cache w sekundach
+ * @param parent Wskaźnik do rodzica
+ */
+ProxyServer::ProxyServer(const QUrl &upstreamBaseUrl, int cacheTtlSeconds, QObject *parent)
+    : QObject(parent)
+    , server(new QTcpServer(this))
+    , networkManager(new QNetworkAccessManager(this))
+    , refreshTimer(new QTimer(this))
+    , upstreamBaseUrl(upstreamBaseUrl)
+    , cacheTtlSeconds(cacheTtlSeconds)
+{
+    // Bez końcowego ukośnika resolved() pominąłby ostatni segment ścieżki
+    if (!this->upstreamBaseUrl.path().endsWith('/'))
+        this->upstreamBaseUrl.setPath(this->upstreamBaseUrl.path() + '/');
+
+    connect(server, &QTcpServer::newConnection, this, &ProxyServer::onNewConnection);
+    connect(networkManager, &QNetworkAccessManager::finished, this, &ProxyServer::onUpstreamFinished);
+
+    refreshTimer->setInterval(cacheTtlSeconds * 1000);
+    connect(refreshTimer, &QTimer::timeout, this, &ProxyServer::refreshCache);
+}
+
+/**
+ * @brief Uruchamia nasłuchiwanie na podanym adresie i porcie.
+ *
+ * @param address Adres, na którym serwer ma nasłuchiwać
+ * @param port Numer portu
+ * @return true, jeśli serwer został uruchomiony, w przeciwnym razie false
+ */
+bool ProxyServer::listen(const QHostAddress &address, quint16 port) {
+    if (!server->listen(address, port)) {
+        qWarning("Nie udało się uruchomić serwera na porcie %u: %s", port, qPrintable(server->errorString()));
+        return false;
+    }
+    refreshTimer->start();
+    return true;
+}
+
+/**
+ * @brief Przyjmuje nowe połączenia klientów
+ *
+ * Dla każdego połączenia podłącza odczyt danych oraz zwolnienie gniazda po rozłączeniu.
+ */
+void ProxyServer::onNewConnection() {
+    while (QTcpSocket *socket = server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &ProxyServer::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            requestBuffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+/**
+ * @brief Odczytuje dane zapytania od klienta
+ *
+ * Zbiera dane do momentu odebrania kompletnych nagłówków, a następnie
+ * wyodrębnia metodę i ścieżkę z linii zapytania i przekazuje je dalej.
+ */
+void ProxyServer::onReadyRead() {
+    QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket || socket->property("handled").toBool())
+        return; // zapytanie już obsłużone (np. subskrypcja SSE)
+
+    QByteArray &buffer = requestBuffers[socket];
+    buffer += socket->readAll();
+
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        if (buffer.size() > MAX_REQUEST_SIZE) {
+            requestBuffers.remove(socket);
+            sendResponse(socket, 431, "Request Header Fields Too Large", QByteArray());
+        }
+        return;
+    }
+
+    QList<QByteArray> requestLine = buffer.left(buffer.indexOf("\r\n")).split(' ');
+    requestBuffers.remove(socket);
+    socket->setProperty("handled", true);
+
+    if (requestLine.size() != 3) {
+        sendResponse(socket, 400, "Bad Request", QByteArray());
+        return;
+    }
+
+    // Ścieżka bez parametrów zapytania, względem prefiksu REST
+    QString path = QUrl(QString::fromLatin1(requestLine[1])).path();
+    if (!path.startsWith(REST_PREFIX)) {
+        sendResponse(socket, 404, "Not Found", QByteArray());
+        return;
+    }
+    handleRequest(socket, requestLine[0], path.mid(qstrlen(REST_PREFIX)));
+}
+
+/**
+ * @brief Obsługuje kompletne zapytanie HTTP
+ *
+ * Świeże dane z cache wysyłane są od razu. W przeciwnym razie klient dopisywany jest
+ * do listy oczekujących na zapytanie do API – jeśli takie zapytanie już trwa,
+ * nowe nie jest wysyłane.
+ *
+ * @param socket Gniazdo klienta
+ * @param method Metoda HTTP
+ * @param path Ścieżka względem `/pjp-api/rest/`
+ */
+void ProxyServer::handleRequest(QTcpSocket *socket, const QByteArray &method, const QString &path) {
+    if (method != "GET") {
+        sendResponse(socket, 405, "Method Not Allowed", QByteArray());
+        return;
+    }
+
+    if (path == "events") {
+        socket->write("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/event-stream\r\n"
+                      "Cache-Control: no-cache\r\n"
+                      "Connection: keep-alive\r\n"
+                      "\r\n");
+        subscribers.append(socket);
+        return;
+    }
+
+    if (path == "aggregate/latest") {
+        sendResponse(socket, 200, "OK", latestPerStation());
+        return;
+    }
+
+    if (!isProxiedPath(path)) {
+        sendResponse(socket, 404, "Not Found", QByteArray());
+        return;
+    }
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    auto it = cache.find(path);
+    if (it != cache.end() && it->fetchedAt.secsTo(now) < cacheTtlSeconds) {
+        it->lastAccess = now;
+        sendResponse(socket, 200, "OK", it->body, "HIT");
+        return;
+    }
+
+    bool inFlight = pendingClients.contains(path);
+    pendingClients[path].append(socket);
+    if (!inFlight)
+        fetchUpstream(path);
+}
+
+/**
+ * @brief Wysyła zapytanie do API GIOŚ, jeśli nie jest już w toku
+ *
+ * Obecność ścieżki w `pendingClients` oznacza trwające zapytanie, więc kolejni
+ * klienci jedynie dołączają do listy oczekujących.
+ *
+ * @param path Ścieżka względem adresu bazowego API
+ */
+void ProxyServer::fetchUpstream(const QString &path) {
+    pendingClients[path]; // oznaczenie zapytania jako trwającego
+
+    QNetworkRequest request(upstreamBaseUrl.resolved(QUrl(path)));
+    request.setAttribute(QNetworkRequest::User, path);
+    networkManager->get(request);
+}
+
+/**
+ * @brief Obsługuje odpowiedź z API GIOŚ
+ *
+ * Zapisuje poprawną odpowiedź w cache, powiadamia subskrybentów i wysyła ją
+ * wszystkim oczekującym klientom. Przy błędzie klienci dostają ostatnią zapisaną
+ * odpowiedź (jeśli istnieje) lub status 502. Czas ostatniego odczytu zmienia się
+ * tylko wtedy, gdy na odpowiedź czekali klienci – samo odświeżenie go nie przedłuża.
+ *
+ * @param reply Odpowiedź z serwera
+ */
+void ProxyServer::onUpstreamFinished(QNetworkReply *reply) {
+    QString path = reply->request().attribute(QNetworkRequest::User).toString();
+    QList<QPointer<QTcpSocket>> clients = pendingClients.take(path);
+    QDateTime now = QDateTime::currentDateTimeUtc();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        CacheEntry &entry = cache[path];
+        entry.body = reply->readAll();
+        entry.fetchedAt = now;
+        if (!clients.isEmpty() || !entry.lastAccess.isValid())
+            entry.lastAccess = now;
+        updateModel(path, entry.body);
+        notifySubscribers(path);
+
+        for (const QPointer<QTcpSocket> &client : clients) {
+            if (client)
+                sendResponse(client, 200, "OK", entry.body, "MISS");
+        }
+    } else {
+        qWarning("Błąd zapytania do API dla %s: %s", qPrintable(path), qPrintable(reply->errorString()));
+
+        auto it = cache.find(path);
+        if (it != cache.end() && !clients.isEmpty())
+            it->lastAccess = now;
+        for (const QPointer<QTcpSocket> &client : clients) {
+            if (!client)
+                continue;
+            if (it != cache.end())
+                sendResponse(client, 200, "OK", it->body, "STALE");
+            else
+                sendResponse(client, 502, "Bad Gateway", QByteArray());
+        }
+    }
+
+    reply->deleteLater(); // Zwolnienie pamięci
+}
+
+/**
+ * @brief Aktualizuje model danych na podstawie odpowiedzi API
+ *
+ * @param path Ścieżka odpowiedzi względem adresu bazowego API
+ * @param body Treść odpowiedzi (JSON)
+ */
+void ProxyServer::updateModel(const QString &path, const QByteArray &body) {
+    if (path == "station/findAll") {
+        model.loadStations(body);
+    } else if (path.startsWith("station/sensors/")) {
+        model.loadSensors(body);
+    } else if (path.startsWith("data/getData/")) {
+        model.loadMeasurements(path.mid(qstrlen("data/getData/")).toUInt(), body);
+    }
+}
+
+/**
+ * @brief Odświeża ścieżki przechowywane w cache i usuwa nieużywane
+ *
+ * Ścieżki, których żaden klient nie odczytał przez `IDLE_EVICT_TTLS` okresów ważności,
+ * są usuwane z cache i nie są dalej odświeżane (dane w modelu pozostają jako ostatnie znane).
+ * Pozostałe ścieżki są pobierane ponownie w równych odstępach w ciągu okresu odświeżania,
+ * zamiast wszystkie naraz. Liczba zapytań do API zależy tylko od liczby używanych ścieżek,
+ * a nie od liczby podłączonych klientów. Subskrybenci dostają przy okazji komentarz SSE
+ * podtrzymujący połączenie.
+ */
+void ProxyServer::refreshCache() {
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    qint64 idleLimit = qint64(IDLE_EVICT_TTLS) * cacheTtlSeconds;
+
+    QList<QString> paths;
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (!pendingClients.contains(it.key()) && it->lastAccess.secsTo(now) >= idleLimit) {
+            it = cache.erase(it);
+        } else {
+            paths.append(it.key());
+            ++it;
+        }
+    }
+
+    int interval = refreshTimer->interval();
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        const QString path = paths.at(i);
+        QTimer::singleShot(int(i * interval / paths.size()), this, [this, path]() {
+            if (cache.contains(path) && !pendingClients.contains(path))
+                fetchUpstream(path);
+        });
+    }
+
+    subscribers.removeAll(nullptr);
+    for (const QPointer<QTcpSocket> &subscriber : std::as_const(subscribers))
+        subscriber->write(": ping\n\n");
+}
+
+/**
+ * @brief Wysyła odpowiedź HTTP i zamyka połączenie
+ *
+ * @param socket Gniazdo klienta
+ * @param status Kod statusu HTTP
+ * @param reason Opis statusu HTTP
+ * @param body Treść odpowiedzi
+ * @param cacheStatus Wartość nagłówka `X-Cache` (HIT, MISS lub STALE)
+ */
+void ProxyServer::sendResponse(QTcpSocket *socket, int status, const QByteArray &reason,
+                               const QByteArray &body, const QByteArray &cacheStatus) {
+    QByteArray header = "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+    header += "Content-Type: application/json; charset=utf-8\r\n";
+    header += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    if (!cacheStatus.isEmpty())
+        header += "X-Cache: " + cacheStatus + "\r\n";
+    header += "Connection: close\r\n\r\n";
+
+    socket->write(header);
+    socket->write(body);
+    socket->disconnectFromHost();
+}
+
+/**
+ * @brief Wysyła powiadomienie o odświeżeniu ścieżki do subskrybentów
+ *
+ * Zdarzenie `update` zawiera ścieżkę i czas pobrania danych. Klient może następnie
+ * pobrać dane tą samą ścieżką – zostaną one wysłane z cache.
+ *
+ * @param path Odświeżona ścieżka
+ */
+void ProxyServer::notifySubscribers(const QString &path) {
+    subscribers.removeAll(nullptr);
+    if (subscribers.isEmpty())
+        return;
+
+    QJsonObject event;
+    event["path"] = path;
+    event["fetchedAt"] = cache.value(path).fetchedAt.toString(Qt::ISODate);
+    QByteArray message = "event: update\ndata: " + QJsonDocument(event).toJson(QJsonDocument::Compact) + "\n\n";
+
+    for (const QPointer<QTcpSocket> &subscriber : std::as_const(subscribers))
+        subscriber->write(message);
+}
+
+/**
+ * @brief Buduje zestawienie najnowszych wartości dla każdej stacji
+ *
+ * Zestawienie powstaje wyłącznie z modelu danych zasilanego odpowiedziami z cache
+ * (listy czujników stacji oraz serie pomiarowe), więc nie generuje dodatkowych zapytań
+ * do API ani ponownego parsowania JSON. Dla każdego czujnika wybierana jest najnowsza wartość.
+ *
+ * @return Tablica JSON obiektów `{stationId, values: [{sensorId, key, date, value}]}`
+ */
+QByteArray ProxyServer::latestPerStation() const {
+    QMap<quint32, QJsonArray> stations;
+
+    for (const SensorRecord &sensor : model.sensors()) {
+        if (sensor.stationId == 0 || sensor.seriesCount == 0)
+            continue;
+
+        quint32 latest = 0;
+        for (quint32 i = 1; i < sensor.seriesCount; ++i) {
+            if (sensor.series.timestamps[i] > sensor.series.timestamps[latest])
+                latest = i;
+        }
+
+        QJsonObject entry;
+        entry["sensorId"] = qint64(sensor.id);
+        entry["key"] = model.text(sensor.paramCode);
+        entry["date"] = QDateTime::fromSecsSinceEpoch(sensor.series.timestamps[latest]).toString("yyyy-MM-dd HH:mm:ss");
+        entry["value"] = sensor.series.values[latest];
+        stations[sensor.stationId].append(entry);
+    }
+
+    QJsonArray result;
+    for (auto it = stations.constBegin(); it != stations.constEnd(); ++it) {
+        QJsonObject station;
+        station["stationId"] = qint64(it.key());
+        station["values"] = it.value();
+        result.append(station);
+    }
+    return QJsonDocument(result).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Sprawdza, czy ścieżka jest przekazywana do API GIOŚ
+ *
+ * Serwer nie jest otwartym proxy – przekazywane są tylko ścieżki używane przez aplikację.
+ *
+ * @param path Ścieżka względem `/pjp-api/rest/`
+ * @return true dla ścieżek stacji, czujników i danych pomiarowych
+ */
+bool ProxyServer::isProxiedPath(const QString &path) {
+    if (path == "station/findAll")
+        return true;
+
+    for (const char *prefix : {"station/sensors/", "data/getData/"}) {
+        if (path.startsWith(prefix)) {
+            bool ok = false;
+            path.mid(qstrlen(prefix)).toInt(&ok);
+            return ok;
+        }
+    }
+    return false;
+}
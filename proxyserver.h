@@ -0,0 +1,173 @@
+/**
+ * @file proxyserver.h
+ * @brief Nagłówek klasy ProxyServer.
+ *
+ * Plik ten zawiera deklarację klasy ProxyServer, która udostępnia lokalnie te same
+ * ścieżki REST co API GIOŚ (`/pjp-api/rest/...`) i obsługuje je ze wspólnego cache.
+ * Dzięki temu wiele instancji aplikacji (np. ekrany ścienne) może wskazywać na jeden
+ * serwer, a liczba zapytań do API GIOŚ nie rośnie wraz z liczbą ekranów.
+ *
+ * Obsługiwane ścieżki:
+ * - `station/findAll`, `station/sensors/{id}`, `data/getData/{id}`: odpowiedzi API GIOŚ z cache.
+ * - `aggregate/latest`: najnowsza wartość każdego parametru dla każdej stacji (z modelu AirQualityModel).
+ * - `events`: strumień Server-Sent Events z powiadomieniami o odświeżeniu danych.
+ */
+
+#ifndef PROXYSERVER_H
+#define PROXYSERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QDateTime>
+#include <QUrl>
+#include <QHostAddress>
+#include "airqualitymodel.h"
+
+QT_BEGIN_NAMESPACE
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+class QNetworkAccessManager;
+class QNetworkReply;
+QT_END_NAMESPACE
+
+/**
+ * @class ProxyServer
+ * @brief Lokalny serwer pośredniczący z cache dla API GIOŚ.
+ *
+ * Serwer przyjmuje zapytania HTTP GET, odpowiada z cache, jeśli dane są świeże,
+ * a w przeciwnym razie pobiera je z API GIOŚ. Jednoczesne zapytania o tę samą ścieżkę
+ * są łączone w jedno zapytanie do API. Ścieżki znajdujące się w cache są okresowo
+ * odświeżane, a subskrybenci strumienia `events` dostają powiadomienie o każdej zmianie.
+ * Ścieżki, których żaden klient nie odczytał przez kilka okresów ważności, są usuwane z cache.
+ */
+class ProxyServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy ProxyServer.
+     *
+     * @param upstreamBaseUrl Adres bazowy API GIOŚ (brakujący końcowy `/` jest dopisywany).
+     * @param cacheTtlSeconds Czas ważności danych w cache w sekundach.
+     * @param parent Opcjonalny wskaźnik do rodzica (domyślnie nullptr).
+     */
+    explicit ProxyServer(const QUrl &upstreamBaseUrl, int cacheTtlSeconds = 300, QObject *parent = nullptr);
+
+    /**
+     * @brief Uruchamia nasłuchiwanie na podanym adresie i porcie.
+     *
+     * @param address Adres, na którym serwer ma nasłuchiwać.
+     * @param port Numer portu.
+     * @return true, jeśli serwer został uruchomiony, w przeciwnym razie false.
+     */
+    bool listen(const QHostAddress &address, quint16 port);
+
+private:
+    /**
+     * @struct CacheEntry
+     * @brief Odpowiedź API GIOŚ przechowywana w cache.
+     */
+    struct CacheEntry {
+        QByteArray body;      /**< Treść odpowiedzi (JSON) */
+        QDateTime fetchedAt;  /**< Czas pobrania odpowiedzi z API */
+        QDateTime lastAccess; /**< Czas ostatniego wysłania odpowiedzi klientowi */
+    };
+
+    QTcpServer *server; /**< Serwer TCP przyjmujący połączenia HTTP */
+    QNetworkAccessManager *networkManager; /**< Menedżer sieciowy do zapytań do API GIOŚ */
+    QTimer *refreshTimer; /**< Zegar okresowego odświeżania cache */
+    QUrl upstreamBaseUrl; /**< Adres bazowy API GIOŚ */
+    int cacheTtlSeconds; /**< Czas ważności danych w cache w sekundach */
+    QHash<QString, CacheEntry> cache; /**< Cache odpowiedzi według ścieżki względnej */
+    QHash<QString, QList<QPointer<QTcpSocket>>> pendingClients; /**< Klienci czekający na trwające zapytanie do API */
+    QHash<QTcpSocket*, QByteArray> requestBuffers; /**< Niepełne nagłówki zapytań klientów */
+    QList<QPointer<QTcpSocket>> subscribers; /**< Subskrybenci strumienia Server-Sent Events */
+    AirQualityModel model; /**< Zwarty model danych z odpowiedzi w cache */
+
+    /**
+     * @brief Obsługuje kompletne zapytanie HTTP.
+     *
+     * @param socket Gniazdo klienta.
+     * @param method Metoda HTTP.
+     * @param path Ścieżka względem `/pjp-api/rest/`.
+     */
+    void handleRequest(QTcpSocket *socket, const QByteArray &method, const QString &path);
+
+    /**
+     * @brief Wysyła zapytanie do API GIOŚ, jeśli nie jest już w toku.
+     *
+     * @param path Ścieżka względem adresu bazowego API.
+     */
+    void fetchUpstream(const QString &path);
+
+    /**
+     * @brief Wysyła odpowiedź HTTP i zamyka połączenie.
+     *
+     * @param socket Gniazdo klienta.
+     * @param status Kod statusu HTTP.
+     * @param reason Opis statusu HTTP.
+     * @param body Treść odpowiedzi.
+     * @param cacheStatus Wartość nagłówka `X-Cache` (pusta, jeśli nagłówek ma być pominięty).
+     */
+    void sendResponse(QTcpSocket *socket, int status, const QByteArray &reason,
+                      const QByteArray &body, const QByteArray &cacheStatus = QByteArray());
+
+    /**
+     * @brief Wysyła powiadomienie o odświeżeniu ścieżki do subskrybentów.
+     *
+     * @param path Odświeżona ścieżka.
+     */
+    void notifySubscribers(const QString &path);
+
+    /**
+     * @brief Aktualizuje model danych na podstawie odpowiedzi API.
+     *
+     * @param path Ścieżka odpowiedzi względem adresu bazowego API.
+     * @param body Treść odpowiedzi (JSON).
+     */
+    void updateModel(const QString &path, const QByteArray &body);
+
+    /**
+     * @brief Buduje zestawienie najnowszych wartości dla każdej stacji.
+     *
+     * @return Zestawienie w formacie JSON.
+     */
+    QByteArray latestPerStation() const;
+
+    /**
+     * @brief Sprawdza, czy ścieżka jest przekazywana do API GIOŚ.
+     *
+     * @param path Ścieżka względem `/pjp-api/rest/`.
+     * @return true dla ścieżek stacji, czujników i danych pomiarowych.
+     */
+    static bool isProxiedPath(const QString &path);
+
+private slots:
+    /**
+     * @brief Przyjmuje nowe połączenia klientów.
+     */
+    void onNewConnection();
+
+    /**
+     * @brief Odczytuje dane zapytania od klienta.
+     */
+    void onReadyRead();
+
+    /**
+     * @brief Obsługuje odpowiedź z API GIOŚ.
+     *
+     * @param reply Odpowiedź z serwera.
+     */
+    void onUpstreamFinished(QNetworkReply *reply);
+
+    /**
+     * @brief Odświeża ścieżki przechowywane w cache i usuwa nieużywane.
+     */
+    void refreshCache();
+};
+
+#endif // PROXYSERVER_H